@@ -1,15 +1,124 @@
 var initialised = false;
 
+var SEND_DELAY_MS = 500;	//Coalesce rapid changes
+var RETRY_BASE_MS = 1000;	//First retry, doubled on every NACK
+var RETRY_MAX = 5;
+
+var pending = {};		//Changed keys not yet acknowledged, kept in 'mid_pla_pending'
+var sending = null;		//Keys in flight
+var retries = 0;
+var sendTimer = null;
+
+//Bit order of the packed flags, must match FlagKeys in main.c
+var FLAG_KEYS = ['inv', 'anim', 'stars', 'vibr', 'astro', 'infr'];
+
+//Flags as 0/1, date as yyyymmdd integer
+function encodeOption(key, value) {
+    if (key === 'date')
+        return parseInt(value, 10) || 0;
+    return value === 'yes' ? 1 : 0;
+}
+
+//Compact message: changed flags as two bytes [changed mask, values], date as int32
+function packMessage(opt) {
+    var msg = {}, mask = 0, bits = 0;
+    for (var i = 0; i < FLAG_KEYS.length; i++) {
+        if (opt.hasOwnProperty(FLAG_KEYS[i])) {
+            mask |= 1 << i;
+            if (opt[FLAG_KEYS[i]])
+                bits |= 1 << i;
+        }
+    }
+    if (mask)
+        msg.flags = [mask, bits];
+    if (opt.hasOwnProperty('date'))
+        msg.date = opt.date;
+    return msg;
+}
+
+function diffOptions(oldOpt, newOpt) {
+    var delta = {};
+    for (var key in newOpt) {
+        if (!newOpt.hasOwnProperty(key))
+            continue;
+        if (oldOpt === null || oldOpt[key] !== newOpt[key])
+            delta[key] = encodeOption(key, newOpt[key]);
+    }
+    return delta;
+}
+
+//Store every unacknowledged key so a restart can pick up where we stopped
+function saveQueue() {
+    var queue = {}, key;
+    for (key in sending)
+        queue[key] = sending[key];
+    for (key in pending)
+        queue[key] = pending[key];
+    if (Object.keys(queue).length > 0)
+        localStorage.setItem('mid_pla_pending', JSON.stringify(queue));
+    else
+        localStorage.removeItem('mid_pla_pending');
+}
+
+function scheduleSend(delay) {
+    if (sendTimer !== null)
+        clearTimeout(sendTimer);
+    sendTimer = setTimeout(sendPending, delay);
+}
+
+function sendPending() {
+    sendTimer = null;
+    if (sending !== null || Object.keys(pending).length === 0)
+        return;
+
+    sending = pending;
+    pending = {};
+    var msg = packMessage(sending);
+    console.log("sending options: " + JSON.stringify(msg));
+    Pebble.sendAppMessage(msg, appMessageAck, appMessageNack);
+}
+
 function appMessageAck(e) {
     console.log("options sent to Pebble successfully");
+    sending = null;
+    retries = 0;
+    saveQueue();
+
+    //Changes made while in flight
+    if (Object.keys(pending).length > 0)
+        scheduleSend(0);
 }
 
 function appMessageNack(e) {
-    console.log("options not sent to Pebble: " + e.error.message);
+    console.log("options not sent to Pebble: " + (e.error ? e.error.message : "unknown"));
+
+    //Newer values in pending win over the failed ones
+    for (var key in sending) {
+        if (sending.hasOwnProperty(key) && !pending.hasOwnProperty(key))
+            pending[key] = sending[key];
+    }
+    sending = null;
+
+    if (retries < RETRY_MAX) {
+        var delay = RETRY_BASE_MS * Math.pow(2, retries++);
+        console.log("retry " + retries + " in " + delay + " ms");
+        scheduleSend(delay);
+    } else {
+        //Give up for now, the queue goes out with the next save or launch
+        console.log("giving up, keeping " + Object.keys(pending).length + " keys queued");
+        retries = 0;
+    }
 }
 
 Pebble.addEventListener("ready", function() {
     initialised = true;
+
+    //Keys left unacknowledged by the last session
+    var queue = JSON.parse(localStorage.getItem('mid_pla_pending'));
+    if (queue !== null && Object.keys(queue).length > 0) {
+        pending = queue;
+        scheduleSend(0);
+    }
 });
 
 Pebble.addEventListener("showConfiguration", function() {
@@ -35,9 +144,22 @@ Pebble.addEventListener("webviewclosed", function(e) {
     console.log("configuration closed");
     if (e.response !== '') {
         var options = JSON.parse(decodeURIComponent(e.response));
+        var oldOptions = JSON.parse(localStorage.getItem('mid_pla_opt'));
         console.log("storing options: " + JSON.stringify(options));
         localStorage.setItem('mid_pla_opt', JSON.stringify(options));
-        Pebble.sendAppMessage(options, appMessageAck, appMessageNack);
+
+        var delta = diffOptions(oldOptions, options);
+        for (var key in delta) {
+            if (delta.hasOwnProperty(key))
+                pending[key] = delta[key];
+        }
+        saveQueue();
+
+        //Also retries keys left over from a give-up
+        if (Object.keys(pending).length > 0)
+            scheduleSend(SEND_DELAY_MS);
+        else
+            console.log("options unchanged");
     } else {
         console.log("no options received");
     }
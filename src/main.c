@@ -10,9 +10,44 @@ enum ConfigKeys {
 	CONFIG_KEY_VIBR=4,
 	CONFIG_KEY_DATE=5,
 	CONFIG_KEY_ASTRO=6,
-	CONFIG_KEY_INFR=7
+	CONFIG_KEY_INFR=7,
+	CONFIG_KEY_FLAGS=9	//Message only, [changed mask, values]
 };
 
+//Bit order of the packed flags, must match FLAG_KEYS in pebble-js-app.js
+static const uint32_t FlagKeys[] = {
+	CONFIG_KEY_INV, CONFIG_KEY_ANIM, CONFIG_KEY_STARS, CONFIG_KEY_VIBR, CONFIG_KEY_ASTRO, CONFIG_KEY_INFR
+};
+
+typedef struct {	//Level of detail per zoom level
+	int16_t scale;		//Orbit scale, 1/256
+	int16_t radV;		//Distance of the view center from the sun
+	int16_t radD;		//Radius of the hour dial, orbits beyond are not drawn
+	uint8_t star_step;	//Draw every n-th star
+	uint8_t label_step;	//Hour label every n hours
+	bool astro_band;	//Asteroids as band instead of dots
+	bool flat;			//Planets as filled circles, no moon and rings
+} Zoom_t;
+
+#define ZOOM_MAX 3
+#define ZOOM_DEFAULT 1
+#define ZOOM_TIMEOUT_MS 20000	//Back to ZOOM_DEFAULT, wrist flicks also tap
+static const Zoom_t ZoomLevels[ZOOM_MAX] = {
+	{85, 0, 60, 2, 3, true, true},			//Full solar system, Neptun inside the dial
+	{256, 85, 145, 1, 1, false, false},		//Normal
+	{512, 95, 155, 1, 1, false, false}		//Inner planets, up to Mars
+};
+#define DIAL_CLEAR 8	//Gap between the outermost orbit and the dial
+
+//Frame budget in draw calls (pixel, line, circle, bitmap), shading is drawn only
+//while it fits, test/render_budget.c checks the worst case at every zoom level
+#define FRAME_BUDGET 4000
+#define COST_TEXT 10
+#define COST_SHADE 140	//Both halves of one shading ring
+#define COST_RINGS 240	//Saturn rings
+#define COST_TAIL 4		//Lucky star and hand
+#define COST_RESERVE (COST_RINGS + PLANETS_MAX + 2 + COST_TAIL)	//Still to come after a shaded planet
+
 typedef struct {
 	bool inv;
 	bool anim;
@@ -76,6 +111,27 @@ static const struct GPathInfo STAR_PATH_INFO = {
 
 GPath *hand_path, *star_path;
 
+typedef struct {	//Rasterized path at a quantized angle
+	const GPathInfo *info;	//Source path, NULL if slot is free
+	int32_t angle;			//Quantized angle
+	GBitmap *fill;			//Filled mask, only if requested
+	GBitmap *outline;		//Outline mask, only if requested
+	uint32_t used;			//LRU stamp
+} PathMask_t;
+
+//Hand angles repeat on redraws within the same minute (zoom taps, face uncovered)
+//and the lucky star only moves with its date. The startup sweep visits every
+//angle once, so the hand bypasses the cache until it is initialized.
+#define MASK_ANGLES 256
+#define MASK_CACHE_MAX 3
+#ifdef PBL_COLOR
+	#define MASK_OUTLINE false	//Keep the antialiased GPath outline
+#else
+	#define MASK_OUTLINE true
+#endif
+static PathMask_t MaskCache[MASK_CACHE_MAX];
+static uint32_t MaskStamp;
+
 static const uint32_t segments[] = {100, 100, 100};
 static const VibePattern vibe_pat = {
 	.durations = segments,
@@ -88,10 +144,80 @@ Layer *face_layer;
 static GFont digitS;
 char hhBuffer[] = "00";
 static int16_t aktHH, aktMM;
-static AppTimer *timer;
-static bool b_initialized;
+static AppTimer *timer, *startup_timer, *zoom_timer;
+static bool b_initialized, b_started, b_stars, b_astro;
+static time_t launch_s;
+static uint16_t launch_ms;
 static CfgDta_t CfgData;
+static int16_t zoom;
 
+static void startup_callback(void *data);
+//-----------------------------------------------------------------------------------------------------------------------
+static void free_path_mask(PathMask_t *mask)
+{
+	if (mask->fill)
+		gbitmap_destroy(mask->fill);
+	if (mask->outline)
+		gbitmap_destroy(mask->outline);
+	memset(mask, 0, sizeof(PathMask_t));
+}
+//-----------------------------------------------------------------------------------------------------------------------
+static int32_t mask_angle(int32_t angle)
+{
+	int32_t step = TRIG_MAX_ANGLE / MASK_ANGLES;
+	return ((((angle % TRIG_MAX_ANGLE) + TRIG_MAX_ANGLE + step/2) / step) % MASK_ANGLES) * step;
+}
+//-----------------------------------------------------------------------------------------------------------------------
+static PathMask_t *get_path_mask(const GPathInfo *info, int32_t angle, bool fill, bool outline)
+{
+	angle = mask_angle(angle);
+	
+	//Hit, or least recently used slot to replace
+	PathMask_t *mask = &MaskCache[0];
+	for (int i=0; i<MASK_CACHE_MAX; i++)
+	{
+		if (MaskCache[i].info == info && MaskCache[i].angle == angle && 
+			(MaskCache[i].fill || !fill) && (MaskCache[i].outline || !outline))
+		{
+			MaskCache[i].used = ++MaskStamp;
+			return &MaskCache[i];
+		}
+		if (MaskCache[i].used < mask->used)
+			mask = &MaskCache[i];
+	}
+	
+	free_path_mask(mask);
+	if (info->num_points > MASK_MAX_POINTS)
+		return NULL;
+	
+	int16_t radius = PathRadius(info);
+	GPoint pts[MASK_MAX_POINTS];
+	RotatePath(info, angle, GPoint(radius, radius), pts);
+	
+	if (outline)
+	{
+		mask->outline = MaskCreate(radius);
+		if (mask->outline == NULL)
+			return NULL;
+		MaskDrawOutline(mask->outline, pts, info->num_points);
+	}
+	
+	if (fill)
+	{
+		mask->fill = MaskCreate(radius);
+		if (mask->fill == NULL)
+		{
+			free_path_mask(mask);
+			return NULL;
+		}
+		MaskFillPolygon(mask->fill, pts, info->num_points);
+	}
+	
+	mask->info = info;
+	mask->angle = angle;
+	mask->used = ++MaskStamp;
+	return mask;
+}
 //-----------------------------------------------------------------------------------------------------------------------
 static void face_update_proc(Layer *layer, GContext *ctx) 
 {
@@ -113,7 +239,11 @@ static void face_update_proc(Layer *layer, GContext *ctx)
 	
 	//TRIG_MAX_ANGLE * t->tm_sec / 60
 	int32_t angle = (TRIG_MAX_ANGLE * (((aktHH % 12) * 60) + (aktMM / 1))) / (12 * 60),	sinl = sin_lookup(angle), cosl = cos_lookup(angle);
-	int16_t radV = 85, radD = 145, radT = 145;
+	const Zoom_t *lod = &ZoomLevels[zoom];
+	int16_t radV = lod->radV, radD = lod->radD, radT = radD;
+	int32_t cost = 0;
+	#define ZOOM(r) ((int16_t)((int32_t)(r) * lod->scale / 256))
+	#define INSIDE(r, s) (ZOOM(r) + (s) < radD - DIAL_CLEAR)
 	
 	GPoint sub_center, ptLin, ptDot;
 	sub_center.x = (int16_t)(sinl * (int32_t)radV / TRIG_MAX_RATIO) + clock_center.x;
@@ -135,8 +265,13 @@ static void face_update_proc(Layer *layer, GContext *ctx)
 
 		if (ptLin.x > -10 && ptLin.x < bounds.size.w+10 && ptLin.y > -10 && ptLin.y < bounds.size.h+10)
 		{
-			if ((i % 4) == 0)
+			if ((i % (4 * lod->label_step)) == 0)
 			{
+				//Font is loaded after the first frame
+				if (!b_started)
+					continue;
+				cost += COST_TEXT;
+				
 				snprintf(hhBuffer, sizeof(hhBuffer), "%d", (int16_t)i/4);
 				GSize txtSize = graphics_text_layout_get_content_size(hhBuffer, digitS, 
 					bounds, GTextOverflowModeWordWrap, GTextAlignmentCenter);
@@ -150,18 +285,19 @@ static void face_update_proc(Layer *layer, GContext *ctx)
 			}
 			else
 			{
-				graphics_fill_circle(ctx, ptLin, 2);
+				graphics_fill_circle(ctx, ptLin, (i % 4) != 0 && lod->flat ? 1 : 2);
+				cost++;
 			}
 		}
 	}
 	
 	//Draw Stars
-	if (CfgData.stars)
-		for (int i=0; i<STARS_MAX; i++)
+	if (CfgData.stars && b_stars)
+		for (int i=0; i<STARS_MAX; i+=lod->star_step)
 		{
 			GPoint ptStar = {
-				.x = Stars[i].x + clock_center.x - sub_rect.origin.x, 
-				.y = Stars[i].y + clock_center.y - sub_rect.origin.y
+				.x = ZOOM(Stars[i].x) + clock_center.x - sub_rect.origin.x, 
+				.y = ZOOM(Stars[i].y) + clock_center.y - sub_rect.origin.y
 			};
 
 			if (grect_contains_point(&bounds, &ptStar))
@@ -172,21 +308,36 @@ static void face_update_proc(Layer *layer, GContext *ctx)
 				#endif
 
 				graphics_draw_pixel(ctx, ptStar);
+				cost++;
 			}
 		}
 	
 	graphics_context_set_stroke_color(ctx, CfgData.inv ? GColorBlack : GColorWhite);
 	
-	//Draw Asteorids
-	if (CfgData.astro)
+	//Draw Asteorids, too dense for dots at small scale
+	int16_t astro_radius = (Planets[3].radius+Planets[4].radius)/2+1;
+	bool astro = CfgData.astro && INSIDE(astro_radius, 4);
+	if (astro && lod->astro_band)
+	{
+		int16_t radius = ZOOM(astro_radius);
+		ptLin.x = clock_center.x - sub_rect.origin.x;
+		ptLin.y = clock_center.y - sub_rect.origin.y;
+		for (int16_t r = radius-1; r <= radius+1; r++)
+			graphics_draw_circle(ctx, ptLin, r);
+		cost += 3;
+	}
+	else if (astro && b_astro)
 		for (int i=0; i<ASTRO_MAX; i++)
 		{
 			GPoint ptAstro = {
-				.x = Astro[i].x + clock_center.x - sub_rect.origin.x, 
-				.y = Astro[i].y + clock_center.y - sub_rect.origin.y
+				.x = ZOOM(Astro[i].x) + clock_center.x - sub_rect.origin.x, 
+				.y = ZOOM(Astro[i].y) + clock_center.y - sub_rect.origin.y
 			};
 			if (grect_contains_point(&bounds, &ptAstro))
+			{
 				graphics_draw_pixel(ctx, ptAstro);
+				cost++;
+			}
 		}
 	
 	//Draw Sun
@@ -194,30 +345,47 @@ static void face_update_proc(Layer *layer, GContext *ctx)
 	ptLin.y = clock_center.y - sub_rect.origin.y;
 	#ifdef PBL_COLOR
 		graphics_context_set_fill_color(ctx, GColorYellow);
-		graphics_fill_circle(ctx, ptLin, 15);
+		graphics_fill_circle(ctx, ptLin, ZOOM(15));
 		graphics_context_set_fill_color(ctx, GColorIcterine);
-		graphics_fill_circle(ctx, ptLin, 10);
+		graphics_fill_circle(ctx, ptLin, ZOOM(10));
 		graphics_context_set_fill_color(ctx, GColorPastelYellow);
-		graphics_fill_circle(ctx, ptLin, 5);
+		graphics_fill_circle(ctx, ptLin, ZOOM(5));
 	#else
-		graphics_fill_circle(ctx, ptLin, 15);
+		graphics_fill_circle(ctx, ptLin, ZOOM(15));
 	#endif	
+	cost += 3;
 
 	#ifdef PBL_COLOR
 		graphics_context_set_stroke_color(ctx, CfgData.inv ? GColorLightGray : GColorDukeBlue);
 	#endif
 	//Draw Planet Orbits
 	for (int i=0; i<PLANETS_MAX; i++)
-		graphics_draw_circle(ctx, ptLin, Planets[i].radius);
+		if (INSIDE(Planets[i].radius, 0))
+		{
+			graphics_draw_circle(ctx, ptLin, ZOOM(Planets[i].radius));
+			cost++;
+		}
 	
-	//Draw Planets
-	for (int i=0; i<PLANETS_MAX; i++)
+	//Draw Planets, not before the ephemeris is calculated
+	for (int i=0; i<PLANETS_MAX && b_started; i++)
 	{
-		ptLin.x = (int16_t)(Planets[i].sinC * (int32_t)Planets[i].radius / TRIG_MAX_RATIO) + clock_center.x - sub_rect.origin.x;
-		ptLin.y = (int16_t)(-Planets[i].cosC * (int32_t)Planets[i].radius / TRIG_MAX_RATIO) + clock_center.y - sub_rect.origin.y;
-		if (ptLin.x > -Planets[i].radius && ptLin.x < bounds.size.w+Planets[i].radius && ptLin.y > -Planets[i].radius && ptLin.y < bounds.size.h+Planets[i].radius)
+		int16_t radius = ZOOM(Planets[i].radius), size = lod->flat ? (Planets[i].size+1)/2 : Planets[i].size,
+			extent = size;
+		if (!lod->flat && i == 2) //Moon orbit
+			extent = ZOOM(Moon.radius) + Moon.size;
+		else if (!lod->flat && i == 5) //Saturn rings
+			extent = 12;
+		
+		if (!INSIDE(Planets[i].radius, extent))
+			continue;
+		
+		ptLin.x = (int16_t)(Planets[i].sinC * (int32_t)radius / TRIG_MAX_RATIO) + clock_center.x - sub_rect.origin.x;
+		ptLin.y = (int16_t)(-Planets[i].cosC * (int32_t)radius / TRIG_MAX_RATIO) + clock_center.y - sub_rect.origin.y;
+		if (ptLin.x > -extent && ptLin.x < bounds.size.w+extent && ptLin.y > -extent && ptLin.y < bounds.size.h+extent)
 		{
 			#ifdef PBL_COLOR
+				//Shade only while the frame budget allows
+				bool shade = !lod->flat && cost + size * COST_SHADE + COST_RESERVE <= FRAME_BUDGET;
 				GColor cF = GColorWhite, cB = GColorBlack;
 				switch (i)
 				{
@@ -247,39 +415,68 @@ static void face_update_proc(Layer *layer, GContext *ctx)
 					break;
 				}
 
-				//Front side
-				graphics_context_set_stroke_color(ctx, cB);
-				DrawArc2(ctx, ptLin, Planets[i].size, Planets[i].size, Planets[i].angleC-85, Planets[i].angleC+85);
-				//Back side
-				graphics_context_set_stroke_color(ctx, cF);
-				DrawArc2(ctx, ptLin, Planets[i].size, Planets[i].size, Planets[i].angleC+85, Planets[i].angleC+275);
+				if (shade)
+				{
+					//Front side
+					graphics_context_set_stroke_color(ctx, cB);
+					DrawArc2(ctx, ptLin, size, size, Planets[i].angleC-85, Planets[i].angleC+85);
+					//Back side
+					graphics_context_set_stroke_color(ctx, cF);
+					DrawArc2(ctx, ptLin, size, size, Planets[i].angleC+85, Planets[i].angleC+275);
+					cost += size * COST_SHADE;
+				}
+				else
+				{
+					graphics_context_set_fill_color(ctx, cF);
+					graphics_fill_circle(ctx, ptLin, size);
+					cost++;
+				}
 			#else
-				graphics_fill_circle(ctx, ptLin, Planets[i].size);
+				graphics_fill_circle(ctx, ptLin, size);
+				cost++;
 			#endif
 			
+			if (lod->flat)
+				continue;
+			
 			if (i == 2) //Moon at Earth
 			{
+				int16_t moon_radius = ZOOM(Moon.radius);
+
 				//Orbit
 				#ifdef PBL_COLOR
 					graphics_context_set_stroke_color(ctx, CfgData.inv ? GColorLightGray : GColorDukeBlue);
-					graphics_draw_circle(ctx, ptLin, Moon.radius);
+					graphics_draw_circle(ctx, ptLin, moon_radius);
 				#else
-					graphics_draw_circle(ctx, ptLin, Moon.radius);
+					graphics_draw_circle(ctx, ptLin, moon_radius);
 				#endif
 				
-				ptLin.x = (int16_t)(Moon.sinC * (int32_t)Moon.radius / TRIG_MAX_RATIO) + ptLin.x;
-				ptLin.y = (int16_t)(-Moon.cosC * (int32_t)Moon.radius / TRIG_MAX_RATIO) + ptLin.y;
+				ptLin.x = (int16_t)(Moon.sinC * (int32_t)moon_radius / TRIG_MAX_RATIO) + ptLin.x;
+				ptLin.y = (int16_t)(-Moon.cosC * (int32_t)moon_radius / TRIG_MAX_RATIO) + ptLin.y;
 				#ifdef PBL_COLOR
 					cF = GColorLightGray; cB = GColorDarkGray;
-					//Front side
-					graphics_context_set_stroke_color(ctx, cB);
-					DrawArc2(ctx, ptLin, Moon.size, Moon.size, Planets[i].angleC-85, Planets[i].angleC+85);
-					//Back side
-					graphics_context_set_stroke_color(ctx, cF);
-					DrawArc2(ctx, ptLin, Moon.size, Moon.size, Planets[i].angleC+85, Planets[i].angleC+275);
+					shade = cost + Moon.size * COST_SHADE + COST_RESERVE <= FRAME_BUDGET;
+					if (shade)
+					{
+						//Front side
+						graphics_context_set_stroke_color(ctx, cB);
+						DrawArc2(ctx, ptLin, Moon.size, Moon.size, Planets[i].angleC-85, Planets[i].angleC+85);
+						//Back side
+						graphics_context_set_stroke_color(ctx, cF);
+						DrawArc2(ctx, ptLin, Moon.size, Moon.size, Planets[i].angleC+85, Planets[i].angleC+275);
+						cost += Moon.size * COST_SHADE;
+					}
+					else
+					{
+						graphics_context_set_fill_color(ctx, cF);
+						graphics_fill_circle(ctx, ptLin, Moon.size);
+						cost++;
+					}
 				#else
 					graphics_fill_circle(ctx, ptLin, Moon.size);
+					cost++;
 				#endif
+				cost++;
 			}
 			else if (i == 5) //Saturn rings
 			{
@@ -290,21 +487,28 @@ static void face_update_proc(Layer *layer, GContext *ctx)
 				graphics_context_set_stroke_color(ctx, CfgData.inv ? GColorWhite : GColorBlack);
 				DrawEllipse(ctx, ptLin.x, ptLin.y, 12, 5, 60, 300);
 				graphics_context_set_stroke_color(ctx, CfgData.inv ? GColorBlack : GColorWhite);
+				cost += COST_RINGS;
 			}
 		}
 	}
 
 	//Draw Lucky Star
-	if (Star.size != 0)
+	if (Star.size != 0 && b_started)
 	{
-		ptLin.x = (int16_t)(Star.sinC * (int32_t)Star.radius / TRIG_MAX_RATIO) + clock_center.x - sub_rect.origin.x;
-		ptLin.y = (int16_t)(-Star.cosC * (int32_t)Star.radius / TRIG_MAX_RATIO) + clock_center.y - sub_rect.origin.y;
+		ptLin.x = (int16_t)(Star.sinC * (int32_t)ZOOM(Star.radius) / TRIG_MAX_RATIO) + clock_center.x - sub_rect.origin.x;
+		ptLin.y = (int16_t)(-Star.cosC * (int32_t)ZOOM(Star.radius) / TRIG_MAX_RATIO) + clock_center.y - sub_rect.origin.y;
 		if (ptLin.x > -10 && ptLin.x < bounds.size.w+10 && ptLin.y > -10 && ptLin.y < bounds.size.h+10)
 		{
-			gpath_move_to(star_path, ptLin);
-			gpath_rotate_to(star_path, Star.angleC);
-			graphics_context_set_stroke_color(ctx, CfgData.inv ? GColorBlack : GColorWhite);
-			gpath_draw_outline(ctx, star_path);
+			PathMask_t *mask = MASK_OUTLINE ? get_path_mask(&STAR_PATH_INFO, Star.angleC, false, true) : NULL;
+			if (mask)
+				DrawMask(ctx, mask->outline, ptLin, CfgData.inv ? GColorBlack : GColorWhite);
+			else
+			{
+				gpath_move_to(star_path, ptLin);
+				gpath_rotate_to(star_path, Star.angleC);
+				graphics_context_set_stroke_color(ctx, CfgData.inv ? GColorBlack : GColorWhite);
+				gpath_draw_outline(ctx, star_path);
+			}
 		}
 	}
 	
@@ -314,17 +518,55 @@ static void face_update_proc(Layer *layer, GContext *ctx)
 		ptLin.x = (int16_t)(sinl * (int32_t)(radD+26) / TRIG_MAX_RATIO) + clock_center.x - sub_rect.origin.x;
 		ptLin.y = (int16_t)(-cosl * (int32_t)(radD+26) / TRIG_MAX_RATIO) + clock_center.y - sub_rect.origin.y;
 
-		gpath_move_to(hand_path, ptLin);
-		gpath_rotate_to(hand_path, angle);
-
 		#ifdef PBL_COLOR
-			graphics_context_set_fill_color(ctx, CfgData.inv ? GColorWindsorTan : GColorYellow);
+			GColor cFill = CfgData.inv ? GColorWindsorTan : GColorYellow;
 		#else
-			graphics_context_set_fill_color(ctx, CfgData.inv ? cInverted : cNormal);
+			GColor cFill = CfgData.inv ? cInverted : cNormal;
 		#endif
-		gpath_draw_filled(ctx, hand_path);
-		graphics_context_set_stroke_color(ctx, CfgData.inv ? GColorWhite : GColorBlack);
-		gpath_draw_outline(ctx, hand_path);
+		GColor cLine = CfgData.inv ? GColorWhite : GColorBlack;
+
+		PathMask_t *mask = b_initialized ? get_path_mask(&HAND_PATH_INFO, angle, true, MASK_OUTLINE) : NULL;
+		if (mask)
+		{
+			DrawMask(ctx, mask->fill, ptLin, cFill);
+			if (mask->outline)
+				DrawMask(ctx, mask->outline, ptLin, cLine);
+			else
+			{
+				//Same quantized angle as the fill
+				gpath_move_to(hand_path, ptLin);
+				gpath_rotate_to(hand_path, mask_angle(angle));
+				graphics_context_set_stroke_color(ctx, cLine);
+				gpath_draw_outline(ctx, hand_path);
+			}
+		}
+		else
+		{
+			gpath_move_to(hand_path, ptLin);
+			gpath_rotate_to(hand_path, angle);
+			graphics_context_set_fill_color(ctx, cFill);
+			gpath_draw_filled(ctx, hand_path);
+			graphics_context_set_stroke_color(ctx, cLine);
+			gpath_draw_outline(ctx, hand_path);
+		}
+	}
+	
+	cost += COST_TAIL;
+	if (cost > FRAME_BUDGET)
+		app_log(APP_LOG_LEVEL_WARNING, __FILE__, __LINE__, "Frame over budget at zoom %d: %d/%d", 
+			(int)zoom, (int)cost, FRAME_BUDGET);
+	#undef ZOOM
+	#undef INSIDE
+	
+	//First frame is up, do the expensive work now
+	if (!b_started && startup_timer == NULL)
+	{
+		time_t now_s;
+		uint16_t now_ms = time_ms(&now_s, NULL);
+		app_log(APP_LOG_LEVEL_INFO, __FILE__, __LINE__, "First frame after %d ms", 
+			(int)((now_s - launch_s) * 1000 + now_ms - launch_ms));
+		
+		startup_timer = app_timer_register(0, startup_callback, NULL);
 	}
 }
 //-----------------------------------------------------------------------------------------------------------------------
@@ -381,6 +623,23 @@ static void handle_tick(struct tm *tick_time, TimeUnits units_changed)
 	}
 }
 //-----------------------------------------------------------------------------------------------------------------------
+static void zoom_callback(void *data)
+{
+	zoom_timer = NULL;
+	zoom = ZOOM_DEFAULT;
+	layer_mark_dirty(face_layer);
+}
+//-----------------------------------------------------------------------------------------------------------------------
+static void tap_handler(AccelAxisType axis, int32_t direction)
+{
+	//Cycle zoom levels, not persisted, falls back after ZOOM_TIMEOUT_MS
+	zoom = (zoom + 1) % ZOOM_MAX;
+	if (zoom_timer)
+		app_timer_cancel(zoom_timer);
+	zoom_timer = zoom != ZOOM_DEFAULT ? app_timer_register(ZOOM_TIMEOUT_MS, zoom_callback, NULL) : NULL;
+	layer_mark_dirty(face_layer);
+}
+//-----------------------------------------------------------------------------------------------------------------------
 static void timerCallback(void *data) 
 {
 	if (!b_initialized)
@@ -407,7 +666,38 @@ static void timerCallback(void *data)
 	}
 }
 //-----------------------------------------------------------------------------------------------------------------------
-static void update_configuration(void)
+static void init_sky(void)
+{
+	//Only build what is shown
+	if (CfgData.stars && !b_stars)
+	{
+		for (int i=0; i<STARS_MAX; i++)
+		{
+			int32_t angleC = TRIG_MAX_ANGLE * i / STARS_MAX, sinC = sin_lookup(angleC), cosC = cos_lookup(angleC),
+				rnd = rand() % 130;
+			
+			Stars[i].x = (int16_t)(sinC * (int32_t)(rnd+20) / TRIG_MAX_RATIO);
+			Stars[i].y = (int16_t)(-cosC * (int32_t)(rnd+20) / TRIG_MAX_RATIO);
+		}
+		b_stars = true;
+	}
+	
+	if (CfgData.astro && !b_astro)
+	{
+		int16_t radius = (Planets[3].radius+Planets[4].radius)/2+1;
+		for (int i=0; i<ASTRO_MAX; i++)
+		{
+			int32_t angleC = TRIG_MAX_ANGLE * i / ASTRO_MAX, sinC = sin_lookup(angleC), cosC = cos_lookup(angleC);
+			int16_t	rnd = rand() % 100, delta = rnd < 10 ? -4 : rnd < 30 ? -2 : rnd > 90 ? 4 : rnd > 70 ? 2 : 0;
+			
+			Astro[i].x = (int16_t)(sinC * (int32_t)(radius+delta) / TRIG_MAX_RATIO);
+			Astro[i].y = (int16_t)(-cosC * (int32_t)(radius+delta) / TRIG_MAX_RATIO);
+		}
+		b_astro = true;
+	}
+}
+//-----------------------------------------------------------------------------------------------------------------------
+static void read_configuration(void)
 {
     if (persist_exists(CONFIG_KEY_INV))
 		CfgData.inv = persist_read_bool(CONFIG_KEY_INV);
@@ -455,6 +745,17 @@ static void update_configuration(void)
 	#else
 		window_set_background_color(window, CfgData.inv ? GColorWhite : GColorBlack);
 	#endif
+}
+//-----------------------------------------------------------------------------------------------------------------------
+static void update_configuration(void)
+{
+	read_configuration();
+	
+	//Rest follows after the first frame
+	if (!b_started)
+		return;
+	
+	init_sky();
 
 	//Get a time structure so that it doesn't start blank
 	time_t temp = time(NULL);
@@ -477,39 +778,96 @@ static void update_configuration(void)
 		b_initialized = true;
 }
 //-----------------------------------------------------------------------------------------------------------------------
+static void startup_callback(void *data)
+{
+	time_t start_s, end_s;
+	uint16_t start_ms = time_ms(&start_s, NULL);
+	
+	startup_timer = NULL;
+	digitS = fonts_load_custom_font(resource_get_handle(RESOURCE_ID_FONT_25));
+	b_started = true;
+	
+	update_configuration();
+	layer_mark_dirty(face_layer);
+	
+	//Work the first frame no longer waits for
+	uint16_t end_ms = time_ms(&end_s, NULL);
+	app_log(APP_LOG_LEVEL_INFO, __FILE__, __LINE__, "Deferred startup took %d ms", 
+		(int)((end_s - start_s) * 1000 + end_ms - start_ms));
+}
+//-----------------------------------------------------------------------------------------------------------------------
+static bool tuple_bool(Tuple *tuple)
+{
+	//Integer 0/1 from the companion, "yes"/"no" from older versions
+	if (tuple->type == TUPLE_CSTRING)
+		return strcmp(tuple->value->cstring, "yes") == 0;
+	return tuple->value->int32 != 0;
+}
+//-----------------------------------------------------------------------------------------------------------------------
 void in_received_handler(DictionaryIterator *received, void *ctx)
 {
 	app_log(APP_LOG_LEVEL_DEBUG, __FILE__, __LINE__, "enter in_received_handler");
     
+	//Only changed keys are sent
 	Tuple *akt_tuple = dict_read_first(received);
     while (akt_tuple)
     {
-        app_log(APP_LOG_LEVEL_DEBUG,
-                __FILE__,
-                __LINE__,
-                "KEY %d=%s", (int16_t)akt_tuple->key,
-                akt_tuple->value->cstring);
+        if (akt_tuple->type == TUPLE_CSTRING)
+            app_log(APP_LOG_LEVEL_DEBUG,
+                    __FILE__,
+                    __LINE__,
+                    "KEY %d=%s", (int16_t)akt_tuple->key,
+                    akt_tuple->value->cstring);
+        else if (akt_tuple->type == TUPLE_BYTE_ARRAY && akt_tuple->length >= 2)
+            app_log(APP_LOG_LEVEL_DEBUG,
+                    __FILE__,
+                    __LINE__,
+                    "KEY %d=%02x/%02x", (int16_t)akt_tuple->key,
+                    akt_tuple->value->data[0], akt_tuple->value->data[1]);
+        else
+            app_log(APP_LOG_LEVEL_DEBUG,
+                    __FILE__,
+                    __LINE__,
+                    "KEY %d=%d", (int16_t)akt_tuple->key,
+                    (int)akt_tuple->value->int32);
+
+		if (akt_tuple->key == CONFIG_KEY_FLAGS && akt_tuple->type == TUPLE_BYTE_ARRAY && akt_tuple->length >= 2)
+		{
+			uint8_t mask = akt_tuple->value->data[0], bits = akt_tuple->value->data[1];
+			for (uint32_t i=0; i<ARRAY_LENGTH(FlagKeys); i++)
+				if (mask & (1 << i))
+					persist_write_bool(FlagKeys[i], (bits & (1 << i)) != 0);
+		}
 
 		if (akt_tuple->key == CONFIG_KEY_INV)
-			persist_write_bool(CONFIG_KEY_INV, strcmp(akt_tuple->value->cstring, "yes") == 0);
+			persist_write_bool(CONFIG_KEY_INV, tuple_bool(akt_tuple));
 		
 		if (akt_tuple->key == CONFIG_KEY_ANIM)
-			persist_write_bool(CONFIG_KEY_ANIM, strcmp(akt_tuple->value->cstring, "yes") == 0);
+			persist_write_bool(CONFIG_KEY_ANIM, tuple_bool(akt_tuple));
 		
 		if (akt_tuple->key == CONFIG_KEY_STARS)
-			persist_write_bool(CONFIG_KEY_STARS, strcmp(akt_tuple->value->cstring, "yes") == 0);
+			persist_write_bool(CONFIG_KEY_STARS, tuple_bool(akt_tuple));
 		
 		if (akt_tuple->key == CONFIG_KEY_VIBR)
-			persist_write_bool(CONFIG_KEY_VIBR, strcmp(akt_tuple->value->cstring, "yes") == 0);
+			persist_write_bool(CONFIG_KEY_VIBR, tuple_bool(akt_tuple));
 		
 		if (akt_tuple->key == CONFIG_KEY_ASTRO)
-			persist_write_bool(CONFIG_KEY_ASTRO, strcmp(akt_tuple->value->cstring, "yes") == 0);
+			persist_write_bool(CONFIG_KEY_ASTRO, tuple_bool(akt_tuple));
 		
 		if (akt_tuple->key == CONFIG_KEY_INFR)
-			persist_write_bool(CONFIG_KEY_INFR, strcmp(akt_tuple->value->cstring, "yes") == 0);
+			persist_write_bool(CONFIG_KEY_INFR, tuple_bool(akt_tuple));
 		
 		if (akt_tuple->key == CONFIG_KEY_DATE)
-			persist_write_string(CONFIG_KEY_DATE, akt_tuple->value->cstring);
+		{
+			if (akt_tuple->type == TUPLE_CSTRING)
+				persist_write_string(CONFIG_KEY_DATE, akt_tuple->value->cstring);
+			else
+			{
+				char date[sizeof(CfgData.date)];
+				snprintf(date, sizeof(date), "%08d", (int)akt_tuple->value->int32);
+				persist_write_string(CONFIG_KEY_DATE, date);
+			}
+		}
 		
 		akt_tuple = dict_read_next(received);
 	}
@@ -531,28 +889,36 @@ static void window_load(Window *window)
 	Layer *window_layer = window_get_root_layer(window);
 	GRect bounds = layer_get_bounds(window_layer);
 	
-	digitS = fonts_load_custom_font(resource_get_handle(RESOURCE_ID_FONT_25));
-	
 	// Init layers
 	face_layer = layer_create(GRect(0, 0, bounds.size.w, bounds.size.h));
 	layer_set_update_proc(face_layer, face_update_proc);
 	layer_add_child(window_layer, face_layer);
 	
-	//Update Configuration
-	update_configuration();
+	//Only colors for the first frame, the hand starts where the animation will
+	read_configuration();
+	
+	time_t temp = time(NULL);
+	struct tm *t = localtime(&temp);
+	aktHH = CfgData.anim ? 0 : t->tm_hour;
+	aktMM = CfgData.anim ? 0 : t->tm_min;
 }
 //-----------------------------------------------------------------------------------------------------------------------
 static void window_unload(Window *window) 
 {
 	layer_destroy(face_layer);
-	fonts_unload_custom_font(digitS);
-	if (!b_initialized)
+	if (b_started)
+		fonts_unload_custom_font(digitS);
+	if (startup_timer)
+		app_timer_cancel(startup_timer);
+	if (!b_initialized && timer)
 		app_timer_cancel(timer);
 }
 //-----------------------------------------------------------------------------------------------------------------------
 static void init(void) 
 {
-	b_initialized = false;
+	time_ms(&launch_s, &launch_ms);
+	b_initialized = b_started = false;
+	zoom = ZOOM_DEFAULT;
 
 	window = window_create();
 	window_set_background_color(window, GColorBlack);
@@ -561,27 +927,8 @@ static void init(void)
 		.unload = window_unload,
 	});
 
-	//Init Stars
+	//Stars and Astros are built after the first frame
 	srand(time(NULL));
-	for (int i=0; i<STARS_MAX; i++)
-	{
-		int32_t angleC = TRIG_MAX_ANGLE * i / STARS_MAX, sinC = sin_lookup(angleC), cosC = cos_lookup(angleC),
-			rnd = rand() % 130;
-		
-		Stars[i].x = (int16_t)(sinC * (int32_t)(rnd+20) / TRIG_MAX_RATIO);
-		Stars[i].y = (int16_t)(-cosC * (int32_t)(rnd+20) / TRIG_MAX_RATIO);
-	}
-	
-	//Init Astros
-	int16_t radius = (Planets[3].radius+Planets[4].radius)/2+1;
-	for (int i=0; i<ASTRO_MAX; i++)
-	{
-		int32_t angleC = TRIG_MAX_ANGLE * i / ASTRO_MAX, sinC = sin_lookup(angleC), cosC = cos_lookup(angleC);
-		int16_t	rnd = rand() % 100, delta = rnd < 10 ? -4 : rnd < 30 ? -2 : rnd > 90 ? 4 : rnd > 70 ? 2 : 0;
-		
-		Astro[i].x = (int16_t)(sinC * (int32_t)(radius+delta) / TRIG_MAX_RATIO);
-		Astro[i].y = (int16_t)(-cosC * (int32_t)(radius+delta) / TRIG_MAX_RATIO);
-	}
 	
 	// Init paths
 	hand_path = gpath_create(&HAND_PATH_INFO);
@@ -592,6 +939,9 @@ static void init(void)
 	
 	//Subscribe ticks
 	tick_timer_service_subscribe(MINUTE_UNIT, handle_tick);
+	
+	//Subscribe taps for zoom
+	accel_tap_service_subscribe(tap_handler);
 
 	//Subscribe messages
 	app_message_register_inbox_received(in_received_handler);
@@ -603,9 +953,14 @@ static void deinit(void)
 {
 	app_message_deregister_callbacks();
 	tick_timer_service_unsubscribe();
+	accel_tap_service_unsubscribe();
+	if (zoom_timer)
+		app_timer_cancel(zoom_timer);
 	
 	gpath_destroy(hand_path);
 	gpath_destroy(star_path);
+	for (int i=0; i<MASK_CACHE_MAX; i++)
+		free_path_mask(&MaskCache[i]);
 	
 	window_destroy(window);
 }
@@ -119,4 +119,148 @@ void DrawArc(GContext *ctx, GPoint p, int radius, int thickness, int start, int
       )
         graphics_draw_pixel(ctx, GPoint(p.x + x, p.y + y));
     }
-}
\ No newline at end of file
+}
+
+//Pre-rotated path masks, 1 bit per pixel
+#define MASK_MAX_POINTS 20
+
+#ifdef PBL_COLOR
+	#define MASK_BIT(x) (0x80 >> ((x) % 8)) //1BitPalette is MSB first
+#else
+	#define MASK_BIT(x) (1 << ((x) % 8))	//1Bit is LSB first
+#endif
+
+int16_t PathRadius(const GPathInfo *info)
+{
+	int32_t r2 = 0;
+	for (uint32_t i = 0; i < info->num_points; i++)
+		r2 = max(r2, info->points[i].x * info->points[i].x + info->points[i].y * info->points[i].y);
+	
+	//Integer square root, rounded up, plus one pixel for rotation rounding
+	int16_t r = 0;
+	while (r * r < r2)
+		r++;
+	return r + 1;
+}
+
+void RotatePath(const GPathInfo *info, int32_t angle, GPoint offset, GPoint *out)
+{
+	int32_t sinA = sin_lookup(angle), cosA = cos_lookup(angle);
+	for (uint32_t i = 0; i < info->num_points; i++)
+	{
+		int32_t x = info->points[i].x, y = info->points[i].y;
+		out[i].x = (int16_t)((x * cosA - y * sinA) / TRIG_MAX_RATIO) + offset.x;
+		out[i].y = (int16_t)((x * sinA + y * cosA) / TRIG_MAX_RATIO) + offset.y;
+	}
+}
+
+void MaskSetPixel(GBitmap *bmp, int16_t x, int16_t y)
+{
+	GRect bounds = gbitmap_get_bounds(bmp);
+	if (x < 0 || y < 0 || x >= bounds.size.w || y >= bounds.size.h)
+		return;
+	
+	uint8_t *data = gbitmap_get_data(bmp);
+	data[y * gbitmap_get_bytes_per_row(bmp) + x / 8] |= MASK_BIT(x);
+}
+
+void MaskDrawLine(GBitmap *bmp, GPoint p1, GPoint p2)
+{
+	int16_t dx = abs(p2.x - p1.x), sx = p1.x < p2.x ? 1 : -1,
+		dy = -abs(p2.y - p1.y), sy = p1.y < p2.y ? 1 : -1,
+		err = dx + dy;
+	
+	while (true)
+	{
+		MaskSetPixel(bmp, p1.x, p1.y);
+		if (p1.x == p2.x && p1.y == p2.y)
+			break;
+		
+		int16_t e2 = 2 * err;
+		if (e2 >= dy)
+		{
+			err += dy;
+			p1.x += sx;
+		}
+		if (e2 <= dx)
+		{
+			err += dx;
+			p1.y += sy;
+		}
+	}
+}
+
+void MaskDrawOutline(GBitmap *bmp, GPoint *pts, uint32_t num)
+{
+	for (uint32_t i = 0; i < num; i++)
+		MaskDrawLine(bmp, pts[i], pts[(i+1) % num]);
+}
+
+void MaskFillPolygon(GBitmap *bmp, GPoint *pts, uint32_t num)
+{
+	GRect bounds = gbitmap_get_bounds(bmp);
+	int16_t xs[MASK_MAX_POINTS];
+	
+	//Even-odd scanline fill
+	for (int16_t y = 0; y < bounds.size.h; y++)
+	{
+		int16_t n = 0;
+		for (uint32_t i = 0; i < num; i++)
+		{
+			GPoint a = pts[i], b = pts[(i+1) % num];
+			if ((a.y <= y && b.y > y) || (b.y <= y && a.y > y))
+				xs[n++] = a.x + (y - a.y) * (b.x - a.x) / (b.y - a.y);
+		}
+		
+		//Insertion sort, there are only a few crossings
+		for (int16_t i = 1; i < n; i++)
+			for (int16_t j = i; j > 0 && xs[j-1] > xs[j]; j--)
+			{
+				int16_t t = xs[j];
+				xs[j] = xs[j-1];
+				xs[j-1] = t;
+			}
+		
+		for (int16_t i = 0; i+1 < n; i += 2)
+			for (int16_t x = xs[i]; x <= xs[i+1]; x++)
+				MaskSetPixel(bmp, x, y);
+	}
+	
+	//Edges too, like gpath_draw_filled, the scanlines skip vertex rows such as the hand tip
+	MaskDrawOutline(bmp, pts, num);
+}
+
+GBitmap *MaskCreate(int16_t radius)
+{
+	GSize size = GSize(2*radius+1, 2*radius+1);
+#ifdef PBL_COLOR
+	GColor *palette = malloc(2 * sizeof(GColor));
+	if (palette == NULL)
+		return NULL;
+	palette[0] = GColorClear;
+	palette[1] = GColorWhite;
+	GBitmap *bmp = gbitmap_create_blank_with_palette(size, GBitmapFormat1BitPalette, palette, true);
+	if (bmp == NULL)
+		free(palette);
+#else
+	GBitmap *bmp = gbitmap_create_blank(size, GBitmapFormat1Bit);
+#endif
+	if (bmp != NULL)
+		memset(gbitmap_get_data(bmp), 0, gbitmap_get_bytes_per_row(bmp) * size.h);
+	return bmp;
+}
+
+void DrawMask(GContext *ctx, GBitmap *bmp, GPoint center, GColor color)
+{
+	GRect bounds = gbitmap_get_bounds(bmp);
+	GRect rect = GRect(center.x - bounds.size.w/2, center.y - bounds.size.h/2, bounds.size.w, bounds.size.h);
+	
+#ifdef PBL_COLOR
+	gbitmap_get_palette(bmp)[1] = color;
+	graphics_context_set_compositing_mode(ctx, GCompOpSet);
+#else
+	graphics_context_set_compositing_mode(ctx, gcolor_equal(color, GColorBlack) ? GCompOpClear : GCompOpOr);
+#endif
+	graphics_draw_bitmap_in_rect(ctx, bmp, rect);
+	graphics_context_set_compositing_mode(ctx, GCompOpAssign);
+}
@@ -0,0 +1,62 @@
+// Watch side of the companion's config messages: packed flags, integer date
+// and the old "yes"/"no" strings
+#define main app_main
+#include "../src/main.c"
+#undef main
+
+static Tuple *tuple(uint32_t key, TupleType type, uint16_t length, const void *data)
+{
+	Tuple *t = calloc(1, sizeof(Tuple) + length + 4);
+	t->key = key;
+	t->type = type;
+	t->length = length;
+	memcpy(t->value, data, length);
+	return t;
+}
+
+static int failed;
+
+static void check(bool ok, const char *what)
+{
+	printf("%-8s %s %s\n", PBL_NAME, ok ? "ok  " : "FAIL", what);
+	if (!ok)
+		failed = 1;
+}
+
+int main(void)
+{
+	char date[9];
+	int32_t day = 20150102;
+	uint8_t flags[] = {0x05, 0x01};	//inv and stars changed, inv on
+	
+	host_reset_persist();
+	persist_write_bool(CONFIG_KEY_STARS, true);
+	persist_write_bool(CONFIG_KEY_ANIM, true);
+	
+	Tuple *packed[] = {
+		tuple(CONFIG_KEY_FLAGS, TUPLE_BYTE_ARRAY, sizeof(flags), flags),
+		tuple(CONFIG_KEY_DATE, TUPLE_INT, sizeof(day), &day)
+	};
+	host_dict_set(packed, ARRAY_LENGTH(packed));
+	in_received_handler(NULL, NULL);
+	
+	persist_read_string(CONFIG_KEY_DATE, date, sizeof(date));
+	check(persist_read_bool(CONFIG_KEY_INV), "changed flag set");
+	check(!persist_read_bool(CONFIG_KEY_STARS), "changed flag cleared");
+	check(persist_read_bool(CONFIG_KEY_ANIM), "unchanged flag kept");
+	check(!persist_exists(CONFIG_KEY_VIBR), "unchanged flag not written");
+	check(strcmp(date, "20150102") == 0, "integer date");
+	
+	Tuple *legacy[] = {
+		tuple(CONFIG_KEY_VIBR, TUPLE_CSTRING, 4, "yes"),
+		tuple(CONFIG_KEY_DATE, TUPLE_CSTRING, 9, "00000000")
+	};
+	host_dict_set(legacy, ARRAY_LENGTH(legacy));
+	in_received_handler(NULL, NULL);
+	
+	persist_read_string(CONFIG_KEY_DATE, date, sizeof(date));
+	check(persist_read_bool(CONFIG_KEY_VIBR), "string flag");
+	check(strcmp(date, "00000000") == 0, "string date");
+	
+	return failed;
+}
@@ -0,0 +1,200 @@
+// Host stand-in for the parts of the Pebble SDK used by src/, so the watch
+// code can be compiled and measured on a PC. Drawing calls are only counted.
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <time.h>
+
+typedef struct { int16_t x, y; } GPoint;
+typedef struct { int16_t w, h; } GSize;
+typedef struct { GPoint origin; GSize size; } GRect;
+#define GPoint(x, y) ((GPoint){(x), (y)})
+#define GSize(w, h) ((GSize){(w), (h)})
+#define GRect(x, y, w, h) ((GRect){{(x), (y)}, {(w), (h)}})
+
+typedef struct { uint8_t argb; } GColor;
+#define GColorClear ((GColor){0x00})
+#define GColorBlack ((GColor){0xC0})
+#define GColorWhite ((GColor){0xFF})
+#define GColorOxfordBlue ((GColor){0xC1})
+#define GColorDukeBlue ((GColor){0xC2})
+#define GColorBulgarianRose ((GColor){0xD0})
+#define GColorArmyGreen ((GColor){0xD4})
+#define GColorWindsorTan ((GColor){0xE4})
+#define GColorRed ((GColor){0xF0})
+#define GColorChromeYellow ((GColor){0xF8})
+#define GColorYellow ((GColor){0xFC})
+#define GColorBrass ((GColor){0xE9})
+#define GColorRajah ((GColor){0xF9})
+#define GColorIcterine ((GColor){0xFD})
+#define GColorPastelYellow ((GColor){0xFE})
+#define GColorDarkGray ((GColor){0xD5})
+#define GColorLightGray ((GColor){0xEA})
+#define GColorLiberty ((GColor){0xD6})
+#define GColorElectricUltramarine ((GColor){0xD3})
+#define GColorVeryLightBlue ((GColor){0xD7})
+#define GColorBabyBlueEyes ((GColor){0xEB})
+bool gcolor_equal(GColor a, GColor b);
+
+typedef struct GContext GContext;
+typedef struct Layer Layer;
+typedef struct Window Window;
+typedef struct GBitmap GBitmap;
+typedef struct GPath GPath;
+typedef struct AppTimer AppTimer;
+typedef struct DictionaryIterator DictionaryIterator;
+typedef struct GFontHost *GFont;
+typedef struct ResHandleHost *ResHandle;
+
+typedef struct GPathInfo { uint32_t num_points; GPoint *points; } GPathInfo;
+
+typedef enum { GBitmapFormat1Bit, GBitmapFormat8Bit, GBitmapFormat1BitPalette, GBitmapFormat2BitPalette } GBitmapFormat;
+typedef enum { GCompOpAssign, GCompOpAssignInverted, GCompOpOr, GCompOpAnd, GCompOpClear, GCompOpSet } GCompOp;
+typedef enum { GTextOverflowModeWordWrap } GTextOverflowMode;
+typedef enum { GTextAlignmentLeft, GTextAlignmentCenter } GTextAlignment;
+typedef enum { SECOND_UNIT = 1, MINUTE_UNIT = 2, HOUR_UNIT = 4, DAY_UNIT = 8, MONTH_UNIT = 16, YEAR_UNIT = 32 } TimeUnits;
+typedef enum { APP_LOG_LEVEL_ERROR = 1, APP_LOG_LEVEL_WARNING = 50, APP_LOG_LEVEL_INFO = 100, APP_LOG_LEVEL_DEBUG = 200 } AppLogLevel;
+typedef enum { ACCEL_AXIS_X, ACCEL_AXIS_Y, ACCEL_AXIS_Z } AccelAxisType;
+typedef int AppMessageResult;
+
+typedef enum { TUPLE_BYTE_ARRAY = 0, TUPLE_CSTRING = 1, TUPLE_UINT = 2, TUPLE_INT = 3 } TupleType;
+typedef struct {
+	uint32_t key;
+	TupleType type:8;
+	uint16_t length;
+	union {
+		uint8_t data[4];
+		char cstring[4];
+		uint8_t uint8;
+		uint16_t uint16;
+		uint32_t uint32;
+		int8_t int8;
+		int16_t int16;
+		int32_t int32;
+	} value[];
+} Tuple;
+
+typedef struct { const uint32_t *durations; uint32_t num_segments; } VibePattern;
+typedef void (*WindowHandler)(Window *window);
+typedef struct { WindowHandler load, appear, disappear, unload; } WindowHandlers;
+typedef void (*LayerUpdateProc)(Layer *layer, GContext *ctx);
+typedef void (*AppTimerCallback)(void *data);
+
+#define TRIG_MAX_ANGLE 0x10000
+#define TRIG_MAX_RATIO 0xffff
+#define ARRAY_LENGTH(a) (sizeof(a) / sizeof((a)[0]))
+#define RESOURCE_ID_FONT_25 1
+
+int32_t sin_lookup(int32_t angle);
+int32_t cos_lookup(int32_t angle);
+
+Layer *layer_create(GRect frame);
+void layer_destroy(Layer *layer);
+GRect layer_get_bounds(const Layer *layer);
+void layer_mark_dirty(Layer *layer);
+void layer_set_update_proc(Layer *layer, LayerUpdateProc update_proc);
+void layer_add_child(Layer *parent, Layer *child);
+
+Window *window_create(void);
+void window_destroy(Window *window);
+Layer *window_get_root_layer(const Window *window);
+void window_set_background_color(Window *window, GColor color);
+void window_set_window_handlers(Window *window, WindowHandlers handlers);
+void window_stack_push(Window *window, bool animated);
+
+void graphics_context_set_stroke_color(GContext *ctx, GColor color);
+void graphics_context_set_fill_color(GContext *ctx, GColor color);
+void graphics_context_set_text_color(GContext *ctx, GColor color);
+void graphics_context_set_compositing_mode(GContext *ctx, GCompOp mode);
+void graphics_draw_pixel(GContext *ctx, GPoint point);
+void graphics_draw_line(GContext *ctx, GPoint p0, GPoint p1);
+void graphics_draw_circle(GContext *ctx, GPoint p, uint16_t radius);
+void graphics_fill_circle(GContext *ctx, GPoint p, uint16_t radius);
+void graphics_draw_bitmap_in_rect(GContext *ctx, const GBitmap *bitmap, GRect rect);
+void graphics_draw_text(GContext *ctx, const char *text, GFont font, GRect box,
+	GTextOverflowMode overflow_mode, GTextAlignment alignment, void *layout);
+GSize graphics_text_layout_get_content_size(const char *text, GFont font, GRect box,
+	GTextOverflowMode overflow_mode, GTextAlignment alignment);
+bool grect_contains_point(const GRect *rect, const GPoint *point);
+
+GPath *gpath_create(const GPathInfo *init);
+void gpath_destroy(GPath *path);
+void gpath_move_to(GPath *path, GPoint point);
+void gpath_rotate_to(GPath *path, int32_t angle);
+void gpath_draw_filled(GContext *ctx, GPath *path);
+void gpath_draw_outline(GContext *ctx, GPath *path);
+
+GBitmap *gbitmap_create_blank(GSize size, GBitmapFormat format);
+GBitmap *gbitmap_create_blank_with_palette(GSize size, GBitmapFormat format, GColor *palette, bool free_on_destroy);
+void gbitmap_destroy(GBitmap *bitmap);
+GRect gbitmap_get_bounds(const GBitmap *bitmap);
+uint8_t *gbitmap_get_data(const GBitmap *bitmap);
+uint16_t gbitmap_get_bytes_per_row(const GBitmap *bitmap);
+GColor *gbitmap_get_palette(const GBitmap *bitmap);
+
+GFont fonts_load_custom_font(ResHandle handle);
+void fonts_unload_custom_font(GFont font);
+ResHandle resource_get_handle(uint32_t resource_id);
+
+void app_log(uint8_t log_level, const char *src_filename, int src_line_number, const char *fmt, ...);
+void vibes_enqueue_custom_pattern(VibePattern pattern);
+uint16_t time_ms(time_t *tloc, uint16_t *out_ms);
+
+AppTimer *app_timer_register(uint32_t timeout_ms, AppTimerCallback callback, void *callback_data);
+void app_timer_cancel(AppTimer *timer);
+
+bool persist_exists(uint32_t key);
+bool persist_read_bool(uint32_t key);
+int32_t persist_read_int(uint32_t key);
+int persist_read_string(uint32_t key, char *buffer, size_t buffer_size);
+int persist_write_bool(uint32_t key, bool value);
+int persist_write_int(uint32_t key, int32_t value);
+int persist_write_string(uint32_t key, const char *cstring);
+
+Tuple *dict_read_first(DictionaryIterator *iter);
+Tuple *dict_read_next(DictionaryIterator *iter);
+
+void tick_timer_service_subscribe(TimeUnits tick_units, void (*handler)(struct tm *tick_time, TimeUnits units_changed));
+void tick_timer_service_unsubscribe(void);
+void accel_tap_service_subscribe(void (*handler)(AccelAxisType axis, int32_t direction));
+void accel_tap_service_unsubscribe(void);
+void app_message_register_inbox_received(void (*handler)(DictionaryIterator *iterator, void *context));
+void app_message_register_inbox_dropped(void (*handler)(AppMessageResult reason, void *context));
+void app_message_open(uint32_t size_inbound, uint32_t size_outbound);
+void app_message_deregister_callbacks(void);
+void app_event_loop(void);
+
+//Host test hooks
+#define rand() host_rand()
+int host_rand(void);
+
+typedef struct {
+	uint32_t draws;			//Pixels, lines, circles and bitmaps
+	uint32_t texts;			//graphics_draw_text
+	uint32_t gpaths;		//gpath_draw_filled/outline
+	uint32_t bitmaps;		//Bitmaps created
+	uint32_t blits;			//Bitmaps drawn
+	uint32_t trig;			//sin_lookup/cos_lookup
+	uint32_t rands;			//rand()
+	uint32_t fonts;			//Custom fonts loaded
+	uint32_t warnings;		//app_log warnings
+	uint32_t persists;		//persist_write_*
+} HostCounters_t;
+
+extern HostCounters_t host_count;
+
+typedef struct {
+	GRect rect;				//Where the last bitmap was drawn
+	GCompOp op;				//Compositing mode it was drawn with
+} HostBlit_t;
+
+extern HostBlit_t host_blit;
+extern GRect host_screen;
+void host_reset_counters(void);
+bool host_run_timers(void);	//Fires due timers, false if none pending
+void host_reset_persist(void);
+void host_dict_set(Tuple **tuples, int count);	//Contents of the next received dictionary
@@ -0,0 +1,305 @@
+// Host implementation of test/host/pebble.h
+#include <math.h>
+#include <stdarg.h>
+#include "pebble.h"
+
+HostCounters_t host_count;
+GRect host_screen = {{0, 0}, {144, 168}};
+HostBlit_t host_blit;
+static GCompOp comp_op;
+
+void host_reset_counters(void)
+{
+	memset(&host_count, 0, sizeof(host_count));
+}
+
+#undef rand
+int host_rand(void)
+{
+	host_count.rands++;
+	return rand();
+}
+
+//-----------------------------------------------------------------------------------------------------------------------
+int32_t sin_lookup(int32_t angle)
+{
+	host_count.trig++;
+	return (int32_t)lround(sin(angle * 2.0 * 3.14159265358979323846 / TRIG_MAX_ANGLE) * TRIG_MAX_RATIO);
+}
+
+int32_t cos_lookup(int32_t angle)
+{
+	host_count.trig++;
+	return (int32_t)lround(cos(angle * 2.0 * 3.14159265358979323846 / TRIG_MAX_ANGLE) * TRIG_MAX_RATIO);
+}
+
+bool gcolor_equal(GColor a, GColor b)
+{
+	return a.argb == b.argb;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------
+struct Layer { GRect frame; LayerUpdateProc update_proc; };
+struct Window { Layer root; WindowHandlers handlers; };
+
+Layer *layer_create(GRect frame)
+{
+	Layer *layer = calloc(1, sizeof(Layer));
+	layer->frame = frame;
+	return layer;
+}
+
+void layer_destroy(Layer *layer) { free(layer); }
+GRect layer_get_bounds(const Layer *layer) { return GRect(0, 0, layer->frame.size.w, layer->frame.size.h); }
+void layer_mark_dirty(Layer *layer) {}
+void layer_set_update_proc(Layer *layer, LayerUpdateProc update_proc) { layer->update_proc = update_proc; }
+void layer_add_child(Layer *parent, Layer *child) {}
+
+Window *window_create(void)
+{
+	Window *window = calloc(1, sizeof(Window));
+	window->root.frame = host_screen;
+	return window;
+}
+
+void window_destroy(Window *window) { free(window); }
+Layer *window_get_root_layer(const Window *window) { return (Layer *)&window->root; }
+void window_set_background_color(Window *window, GColor color) {}
+void window_set_window_handlers(Window *window, WindowHandlers handlers) { window->handlers = handlers; }
+
+void window_stack_push(Window *window, bool animated)
+{
+	if (window->handlers.load)
+		window->handlers.load(window);
+}
+
+//-----------------------------------------------------------------------------------------------------------------------
+void graphics_context_set_stroke_color(GContext *ctx, GColor color) {}
+void graphics_context_set_fill_color(GContext *ctx, GColor color) {}
+void graphics_context_set_text_color(GContext *ctx, GColor color) {}
+void graphics_context_set_compositing_mode(GContext *ctx, GCompOp mode) { comp_op = mode; }
+void graphics_draw_pixel(GContext *ctx, GPoint point) { host_count.draws++; }
+void graphics_draw_line(GContext *ctx, GPoint p0, GPoint p1) { host_count.draws++; }
+void graphics_draw_circle(GContext *ctx, GPoint p, uint16_t radius) { host_count.draws++; }
+void graphics_fill_circle(GContext *ctx, GPoint p, uint16_t radius) { host_count.draws++; }
+void graphics_draw_bitmap_in_rect(GContext *ctx, const GBitmap *bitmap, GRect rect)
+{
+	host_count.draws++;
+	host_count.blits++;
+	host_blit = (HostBlit_t){rect, comp_op};
+}
+
+void graphics_draw_text(GContext *ctx, const char *text, GFont font, GRect box,
+	GTextOverflowMode overflow_mode, GTextAlignment alignment, void *layout)
+{
+	host_count.texts++;
+}
+
+GSize graphics_text_layout_get_content_size(const char *text, GFont font, GRect box,
+	GTextOverflowMode overflow_mode, GTextAlignment alignment)
+{
+	return GSize(12 * strlen(text), 25);
+}
+
+bool grect_contains_point(const GRect *rect, const GPoint *point)
+{
+	return point->x >= rect->origin.x && point->y >= rect->origin.y &&
+		point->x < rect->origin.x + rect->size.w && point->y < rect->origin.y + rect->size.h;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------
+struct GPath { const GPathInfo *info; };
+
+GPath *gpath_create(const GPathInfo *init)
+{
+	GPath *path = calloc(1, sizeof(GPath));
+	path->info = init;
+	return path;
+}
+
+void gpath_destroy(GPath *path) { free(path); }
+void gpath_move_to(GPath *path, GPoint point) {}
+void gpath_rotate_to(GPath *path, int32_t angle) {}
+void gpath_draw_filled(GContext *ctx, GPath *path) { host_count.gpaths++; }
+void gpath_draw_outline(GContext *ctx, GPath *path) { host_count.gpaths++; }
+
+//-----------------------------------------------------------------------------------------------------------------------
+struct GBitmap { GSize size; uint16_t row_size; uint8_t *data; GColor *palette; bool free_palette; };
+
+GBitmap *gbitmap_create_blank(GSize size, GBitmapFormat format)
+{
+	GBitmap *bitmap = calloc(1, sizeof(GBitmap));
+	bitmap->size = size;
+	bitmap->row_size = (format == GBitmapFormat1Bit) ? ((size.w + 31) / 32) * 4 : (size.w + 7) / 8;
+	bitmap->data = calloc(bitmap->row_size, size.h);
+	host_count.bitmaps++;
+	return bitmap;
+}
+
+GBitmap *gbitmap_create_blank_with_palette(GSize size, GBitmapFormat format, GColor *palette, bool free_on_destroy)
+{
+	GBitmap *bitmap = gbitmap_create_blank(size, format);
+	bitmap->palette = palette;
+	bitmap->free_palette = free_on_destroy;
+	return bitmap;
+}
+
+void gbitmap_destroy(GBitmap *bitmap)
+{
+	if (bitmap->free_palette)
+		free(bitmap->palette);
+	free(bitmap->data);
+	free(bitmap);
+}
+
+GRect gbitmap_get_bounds(const GBitmap *bitmap) { return GRect(0, 0, bitmap->size.w, bitmap->size.h); }
+uint8_t *gbitmap_get_data(const GBitmap *bitmap) { return bitmap->data; }
+uint16_t gbitmap_get_bytes_per_row(const GBitmap *bitmap) { return bitmap->row_size; }
+GColor *gbitmap_get_palette(const GBitmap *bitmap) { return bitmap->palette; }
+
+//-----------------------------------------------------------------------------------------------------------------------
+static int font_dummy;
+GFont fonts_load_custom_font(ResHandle handle) { host_count.fonts++; return (GFont)&font_dummy; }
+void fonts_unload_custom_font(GFont font) {}
+ResHandle resource_get_handle(uint32_t resource_id) { return (ResHandle)&font_dummy; }
+
+void app_log(uint8_t log_level, const char *src_filename, int src_line_number, const char *fmt, ...)
+{
+	if (log_level <= APP_LOG_LEVEL_WARNING)
+	{
+		va_list args;
+		va_start(args, fmt);
+		fprintf(stderr, "%s:%d: ", src_filename, src_line_number);
+		vfprintf(stderr, fmt, args);
+		fprintf(stderr, "\n");
+		va_end(args);
+		host_count.warnings++;
+	}
+}
+
+void vibes_enqueue_custom_pattern(VibePattern pattern) {}
+
+uint16_t time_ms(time_t *tloc, uint16_t *out_ms)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	uint16_t ms = (uint16_t)(ts.tv_nsec / 1000000);
+	if (tloc)
+		*tloc = ts.tv_sec;
+	if (out_ms)
+		*out_ms = ms;
+	return ms;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------
+#define HOST_TIMERS 8
+struct AppTimer { AppTimerCallback callback; void *data; bool active; };
+static AppTimer timers[HOST_TIMERS];
+
+AppTimer *app_timer_register(uint32_t timeout_ms, AppTimerCallback callback, void *callback_data)
+{
+	for (int i = 0; i < HOST_TIMERS; i++)
+		if (!timers[i].active)
+		{
+			timers[i] = (AppTimer){callback, callback_data, true};
+			return &timers[i];
+		}
+	return NULL;
+}
+
+void app_timer_cancel(AppTimer *timer)
+{
+	if (timer)
+		timer->active = false;
+}
+
+bool host_run_timers(void)
+{
+	//Timeouts are ignored, every pending timer is due
+	bool fired = false;
+	for (int i = 0; i < HOST_TIMERS; i++)
+		if (timers[i].active)
+		{
+			timers[i].active = false;
+			timers[i].callback(timers[i].data);
+			fired = true;
+		}
+	return fired;
+}
+
+//-----------------------------------------------------------------------------------------------------------------------
+#define HOST_PERSIST 16
+static struct { bool used; int32_t value; char string[32]; } persist[HOST_PERSIST];
+
+void host_reset_persist(void)
+{
+	memset(persist, 0, sizeof(persist));
+}
+
+bool persist_exists(uint32_t key) { return key < HOST_PERSIST && persist[key].used; }
+bool persist_read_bool(uint32_t key) { return persist_exists(key) && persist[key].value != 0; }
+int32_t persist_read_int(uint32_t key) { return persist_exists(key) ? persist[key].value : 0; }
+
+int persist_read_string(uint32_t key, char *buffer, size_t buffer_size)
+{
+	if (!persist_exists(key))
+		return -1;
+	snprintf(buffer, buffer_size, "%s", persist[key].string);
+	return strlen(buffer);
+}
+
+int persist_write_int(uint32_t key, int32_t value)
+{
+	if (key >= HOST_PERSIST)
+		return -1;
+	host_count.persists++;
+	persist[key].used = true;
+	persist[key].value = value;
+	return sizeof(value);
+}
+
+int persist_write_bool(uint32_t key, bool value)
+{
+	return persist_write_int(key, value);
+}
+
+int persist_write_string(uint32_t key, const char *cstring)
+{
+	if (key >= HOST_PERSIST)
+		return -1;
+	host_count.persists++;
+	persist[key].used = true;
+	snprintf(persist[key].string, sizeof(persist[key].string), "%s", cstring);
+	return strlen(persist[key].string);
+}
+
+//-----------------------------------------------------------------------------------------------------------------------
+static Tuple **dict_tuples;
+static int dict_count, dict_pos;
+
+void host_dict_set(Tuple **tuples, int count)
+{
+	dict_tuples = tuples;
+	dict_count = count;
+}
+
+Tuple *dict_read_first(DictionaryIterator *iter)
+{
+	dict_pos = 0;
+	return dict_read_next(iter);
+}
+
+Tuple *dict_read_next(DictionaryIterator *iter)
+{
+	return dict_pos < dict_count ? dict_tuples[dict_pos++] : NULL;
+}
+
+void tick_timer_service_subscribe(TimeUnits tick_units, void (*handler)(struct tm *tick_time, TimeUnits units_changed)) {}
+void tick_timer_service_unsubscribe(void) {}
+void accel_tap_service_subscribe(void (*handler)(AccelAxisType axis, int32_t direction)) {}
+void accel_tap_service_unsubscribe(void) {}
+void app_message_register_inbox_received(void (*handler)(DictionaryIterator *iterator, void *context)) {}
+void app_message_register_inbox_dropped(void (*handler)(AppMessageResult reason, void *context)) {}
+void app_message_open(uint32_t size_inbound, uint32_t size_outbound) {}
+void app_message_deregister_callbacks(void) {}
+void app_event_loop(void) {}
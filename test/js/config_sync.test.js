@@ -0,0 +1,225 @@
+// Companion config sync against a mock of the Pebble JS API, run with "node"
+var assert = require('assert');
+var fs = require('fs');
+var path = require('path');
+var vm = require('vm');
+
+var SOURCE = fs.readFileSync(path.join(__dirname, '../../src/js/pebble-js-app.js'), 'utf8');
+
+var OPTIONS = {inv: 'no', anim: 'yes', stars: 'yes', vibr: 'no', astro: 'no', infr: 'no', date: '00000000'};
+
+//Fresh companion with fake timers, localStorage and Pebble
+function companion(stored) {
+    var app = {now: 0, timers: [], sent: [], store: {}, handlers: {}};
+    for (var key in stored || {})
+        app.store[key] = stored[key];
+
+    var sandbox = {
+        console: {log: function() {}},
+        localStorage: {
+            getItem: function(k) { return app.store.hasOwnProperty(k) ? app.store[k] : null; },
+            setItem: function(k, v) { app.store[k] = String(v); },
+            removeItem: function(k) { delete app.store[k]; }
+        },
+        setTimeout: function(fn, ms) {
+            var timer = {at: app.now + ms, fn: fn};
+            app.timers.push(timer);
+            return timer;
+        },
+        clearTimeout: function(timer) {
+            app.timers = app.timers.filter(function(t) { return t !== timer; });
+        },
+        Pebble: {
+            addEventListener: function(name, fn) { app.handlers[name] = fn; },
+            openURL: function() {},
+            sendAppMessage: function(msg, ack, nack) {
+                app.sent.push({at: app.now, msg: msg, ack: ack, nack: nack});
+            }
+        }
+    };
+    vm.runInNewContext(SOURCE, sandbox);
+    app.sandbox = sandbox;
+
+    app.advance = function(ms) {
+        var end = app.now + ms;
+        for (;;) {
+            var due = app.timers.filter(function(t) { return t.at <= end; })
+                .sort(function(a, b) { return a.at - b.at; })[0];
+            if (!due)
+                break;
+            app.timers.splice(app.timers.indexOf(due), 1);
+            app.now = due.at;
+            due.fn();
+        }
+        app.now = end;
+    };
+    app.close = function(options) {
+        app.handlers.webviewclosed({response: encodeURIComponent(JSON.stringify(options))});
+    };
+    app.ack = function() { app.sent[app.sent.length - 1].ack({}); };
+    app.nack = function() { app.sent[app.sent.length - 1].nack({error: {message: 'busy'}}); };
+    app.handlers.ready();
+    return app;
+}
+
+//Messages come from another realm, compare plain copies
+function message(sent) {
+    return JSON.parse(JSON.stringify(sent.msg));
+}
+
+function change(values) {
+    var options = {};
+    for (var key in OPTIONS)
+        options[key] = OPTIONS[key];
+    for (key in values)
+        options[key] = values[key];
+    return options;
+}
+
+var tests = {
+    'first config sends every option packed': function() {
+        var app = companion();
+        app.close(OPTIONS);
+        app.advance(app.sandbox.SEND_DELAY_MS);
+        assert.strictEqual(app.sent.length, 1);
+        assert.deepStrictEqual(message(app.sent[0]), {flags: [0x3f, 0x06], date: 0});
+    },
+
+    'only keys changed against mid_pla_opt are sent': function() {
+        var app = companion({mid_pla_opt: JSON.stringify(OPTIONS)});
+        app.close(change({inv: 'yes', date: '20150102'}));
+        app.advance(app.sandbox.SEND_DELAY_MS);
+        assert.strictEqual(app.sent.length, 1);
+        assert.deepStrictEqual(message(app.sent[0]), {flags: [0x01, 0x01], date: 20150102});
+        assert.strictEqual(JSON.parse(app.store.mid_pla_opt).inv, 'yes');
+    },
+
+    'unchanged options send nothing': function() {
+        var app = companion({mid_pla_opt: JSON.stringify(OPTIONS)});
+        app.close(OPTIONS);
+        app.advance(10000);
+        assert.strictEqual(app.sent.length, 0);
+    },
+
+    'changes within SEND_DELAY_MS are coalesced': function() {
+        var app = companion({mid_pla_opt: JSON.stringify(OPTIONS)});
+        app.close(change({inv: 'yes'}));
+        app.advance(app.sandbox.SEND_DELAY_MS - 100);
+        assert.strictEqual(app.sent.length, 0);
+        app.close(change({inv: 'yes', astro: 'yes'}));
+        app.advance(app.sandbox.SEND_DELAY_MS);
+        assert.strictEqual(app.sent.length, 1);
+        assert.deepStrictEqual(message(app.sent[0]), {flags: [0x11, 0x11]});
+    },
+
+    'NACK backs off and stops after RETRY_MAX': function() {
+        var app = companion({mid_pla_opt: JSON.stringify(OPTIONS)});
+        app.close(change({vibr: 'yes'}));
+        app.advance(app.sandbox.SEND_DELAY_MS);
+        var max = app.sandbox.RETRY_MAX, base = app.sandbox.RETRY_BASE_MS;
+        for (var i = 0; i < max; i++) {
+            var delay = base * Math.pow(2, i);
+            app.nack();
+            app.advance(delay - 1);
+            assert.strictEqual(app.sent.length, i + 1);
+            app.advance(1);
+            assert.strictEqual(app.sent.length, i + 2);
+        }
+        app.nack();
+        app.advance(60000);
+        assert.strictEqual(app.sent.length, 1 + max);
+        app.sent.forEach(function(s) { assert.deepStrictEqual(message(s), {flags: [0x08, 0x08]}); });
+        assert.deepStrictEqual(JSON.parse(app.store.mid_pla_pending), {vibr: 1});
+        assert.strictEqual(app.timers.length, 0);
+    },
+
+    'queue kept after giving up goes out with the next save': function() {
+        var app = companion({mid_pla_opt: JSON.stringify(OPTIONS)});
+        app.close(change({vibr: 'yes'}));
+        app.advance(app.sandbox.SEND_DELAY_MS);
+        for (var i = 0; i <= app.sandbox.RETRY_MAX; i++) {
+            app.nack();
+            app.advance(60000);
+        }
+        var sent = app.sent.length;
+        app.close(change({vibr: 'yes'}));
+        app.advance(app.sandbox.SEND_DELAY_MS);
+        assert.strictEqual(app.sent.length, sent + 1);
+        assert.deepStrictEqual(message(app.sent[sent]), {flags: [0x08, 0x08]});
+        app.ack();
+        assert.strictEqual(app.store.mid_pla_pending, undefined);
+    },
+
+    'queued changes survive a restart before sending': function() {
+        var app = companion({mid_pla_opt: JSON.stringify(OPTIONS)});
+        app.close(change({stars: 'no'}));
+        app.advance(app.sandbox.SEND_DELAY_MS - 100);
+        assert.strictEqual(app.sent.length, 0);
+
+        //Companion torn down inside the coalescing window
+        var restarted = companion(app.store);
+        restarted.advance(0);
+        assert.strictEqual(restarted.sent.length, 1);
+        assert.deepStrictEqual(message(restarted.sent[0]), {flags: [0x04, 0x00]});
+        restarted.ack();
+        assert.strictEqual(restarted.store.mid_pla_pending, undefined);
+    },
+
+    'in-flight changes survive a restart before the ACK': function() {
+        var app = companion({mid_pla_opt: JSON.stringify(OPTIONS)});
+        app.close(change({inv: 'yes'}));
+        app.advance(app.sandbox.SEND_DELAY_MS);
+        app.close(change({inv: 'yes', infr: 'yes'}));
+
+        var restarted = companion(app.store);
+        restarted.advance(0);
+        assert.strictEqual(restarted.sent.length, 1);
+        assert.deepStrictEqual(message(restarted.sent[0]), {flags: [0x21, 0x21]});
+    },
+
+    'nothing queued sends nothing on ready': function() {
+        var app = companion({mid_pla_opt: JSON.stringify(OPTIONS)});
+        app.advance(10000);
+        assert.strictEqual(app.sent.length, 0);
+    },
+
+    'changes while in flight follow after the ACK': function() {
+        var app = companion({mid_pla_opt: JSON.stringify(OPTIONS)});
+        app.close(change({inv: 'yes'}));
+        app.advance(app.sandbox.SEND_DELAY_MS);
+        assert.strictEqual(app.sent.length, 1);
+        app.close(change({inv: 'yes', infr: 'yes'}));
+        app.advance(10000);
+        assert.strictEqual(app.sent.length, 1);
+        app.ack();
+        app.advance(0);
+        assert.strictEqual(app.sent.length, 2);
+        assert.deepStrictEqual(message(app.sent[1]), {flags: [0x20, 0x20]});
+        assert.deepStrictEqual(JSON.parse(app.store.mid_pla_pending), {infr: 1});
+        app.ack();
+        assert.strictEqual(app.store.mid_pla_pending, undefined);
+    },
+
+    'NACK keeps newer in-flight changes': function() {
+        var app = companion({mid_pla_opt: JSON.stringify(OPTIONS)});
+        app.close(change({inv: 'yes'}));
+        app.advance(app.sandbox.SEND_DELAY_MS);
+        app.close(change({inv: 'no'}));
+        app.nack();
+        app.advance(60000);
+        assert.strictEqual(app.sent.length, 2);
+        assert.deepStrictEqual(message(app.sent[1]), {flags: [0x01, 0x00]});
+    }
+};
+
+var failed = 0;
+Object.keys(tests).forEach(function(name) {
+    try {
+        tests[name]();
+        console.log('js       ok   ' + name);
+    } catch (e) {
+        console.log('js       FAIL ' + name + '\n' + e.message);
+        failed = 1;
+    }
+});
+process.exit(failed);
@@ -0,0 +1,100 @@
+// Hand and lucky-star mask cache hit rate for the startup sweep, infinite
+// rotation and steady minute ticks with extra redraws
+#define main app_main
+#include "../src/main.c"
+#undef main
+
+static uint32_t frames;
+
+static void frame(void)
+{
+	face_update_proc(face_layer, NULL);
+	frames++;
+}
+
+static void start(bool infr)
+{
+	host_reset_persist();
+	persist_write_string(CONFIG_KEY_DATE, "20150101");
+	persist_write_bool(CONFIG_KEY_INFR, infr);
+	init();
+	frame();
+	host_run_timers();	//Deferred startup
+}
+
+static void stop(void)
+{
+	if (!b_initialized && timer)
+		app_timer_cancel(timer);
+	deinit();
+}
+
+static void report(const char *name)
+{
+	double hit = host_count.blits ? 1.0 - (double)host_count.bitmaps / host_count.blits : 0.0;
+	printf("%-8s %-10s %6u %8u %6u %7u %5.0f%%\n", PBL_NAME, name, frames, 
+		host_count.bitmaps, host_count.blits, host_count.gpaths, hit * 100.0);
+}
+
+int main(void)
+{
+	int failed = 0;
+	printf("%-8s %-10s %6s %8s %6s %7s %6s\n", PBL_NAME, "scenario", "frames", "bitmaps", "blits", "gpaths", "hits");
+	
+	//Startup sweep until the hand reaches the current time
+	start(false);
+	host_reset_counters();
+	frames = 0;
+	while (!b_initialized)
+	{
+		frame();
+		host_run_timers();
+	}
+	report("sweep");
+	if (host_count.bitmaps > (MASK_OUTLINE ? 1 : 0))	//Only the lucky star may be built
+	{
+		printf("FAIL: hand masks built during the sweep\n");
+		failed = 1;
+	}
+	
+	//Two hours of minute ticks, each redrawn when uncovered and on three zoom taps
+	host_reset_counters();
+	frames = 0;
+	time_t now = time(NULL);
+	struct tm t = *localtime(&now);
+	for (int minute = 0; minute < 120; minute++)
+	{
+		t.tm_min = (t.tm_min + 1) % 60;
+		if (t.tm_min == 0)
+			t.tm_hour = (t.tm_hour + 1) % 24;
+		handle_tick(&t, MINUTE_UNIT);
+		frame();
+		frame();
+		for (int tap = 0; tap < ZOOM_MAX; tap++)
+		{
+			tap_handler(ACCEL_AXIS_X, 1);
+			frame();
+		}
+	}
+	report("steady");
+	if (host_count.blits == 0 || host_count.bitmaps * 2 > host_count.blits)
+	{
+		printf("FAIL: steady hit rate below 50%%\n");
+		failed = 1;
+	}
+	stop();
+	
+	//Infinite rotation, hand hidden
+	start(true);
+	host_reset_counters();
+	frames = 0;
+	for (int i = 0; i < 300; i++)
+	{
+		frame();
+		host_run_timers();
+	}
+	report("infinite");
+	stop();
+	
+	return failed;
+}
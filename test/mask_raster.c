@@ -0,0 +1,93 @@
+// Pixels of the rasterized hand mask, bit order and where DrawMask places it
+#define main app_main
+#include "../src/main.c"
+#undef main
+
+static int failed;
+
+static bool bit(GBitmap *bmp, int16_t x, int16_t y)
+{
+	return (gbitmap_get_data(bmp)[y * gbitmap_get_bytes_per_row(bmp) + x / 8] & MASK_BIT(x)) != 0;
+}
+
+static void expect(const char *what, GBitmap *bmp, int16_t x, int16_t y, bool set)
+{
+	if (bit(bmp, x, y) != set)
+	{
+		printf("FAIL: %s (%d,%d) should be %s\n", what, x, y, set ? "set" : "clear");
+		failed = 1;
+	}
+}
+
+int main(void)
+{
+	int16_t r = PathRadius(&HAND_PATH_INFO);
+
+	//First pixel of a row: 1Bit is LSB first, 1BitPalette MSB first
+	#ifdef PBL_COLOR
+		if (MASK_BIT(0) != 0x80 || MASK_BIT(7) != 0x01)
+	#else
+		if (MASK_BIT(0) != 0x01 || MASK_BIT(7) != 0x80)
+	#endif
+	{
+		printf("FAIL: MASK_BIT order %02x..%02x\n", MASK_BIT(0), MASK_BIT(7));
+		failed = 1;
+	}
+
+	//Hand points down (tip at +y) at angle 0
+	PathMask_t *mask = get_path_mask(&HAND_PATH_INFO, 0, true, true);
+	GBitmap *fill = mask->fill;
+	if (gbitmap_get_bounds(fill).size.w != 2*r+1 || gbitmap_get_bounds(fill).size.h != 2*r+1)
+	{
+		printf("FAIL: mask size %dx%d for radius %d\n",
+			gbitmap_get_bounds(fill).size.w, gbitmap_get_bounds(fill).size.h, r);
+		failed = 1;
+	}
+	expect("0: tip", fill, r, r+32, true);
+	expect("0: shaft", fill, r, r+10, true);
+	expect("0: centre", fill, r, r, true);
+	expect("0: beyond tip", fill, r, r+r, false);
+	expect("0: behind centre", fill, r, r-10, false);
+	expect("0: left", fill, r-32, r, false);
+	expect("0: right", fill, r+32, r, false);
+	expect("0: corner", fill, 0, 0, false);
+	expect("0: outline tip", mask->outline, r, r+32, true);
+	expect("0: outline inside", mask->outline, r, r+10, false);
+
+	//Quarter turn clockwise on screen, tip at -x
+	mask = get_path_mask(&HAND_PATH_INFO, TRIG_MAX_ANGLE/4, true, true);
+	fill = mask->fill;
+	expect("90: tip", fill, r-32, r, true);
+	expect("90: shaft", fill, r-10, r, true);
+	expect("90: centre", fill, r, r, true);
+	expect("90: right", fill, r+32, r, false);
+	expect("90: down", fill, r, r+32, false);
+	expect("90: corner", fill, 2*r, 2*r, false);
+
+	//Mask centre on the hand centre, black clears on aplite, palette carries the colour on basalt
+	GPoint center = GPoint(72, 84);
+	DrawMask(NULL, fill, center, GColorBlack);
+	if (host_blit.rect.origin.x != center.x - r || host_blit.rect.origin.y != center.y - r ||
+		host_blit.rect.size.w != 2*r+1 || host_blit.rect.size.h != 2*r+1)
+	{
+		printf("FAIL: mask drawn at (%d,%d %dx%d)\n", host_blit.rect.origin.x, host_blit.rect.origin.y,
+			host_blit.rect.size.w, host_blit.rect.size.h);
+		failed = 1;
+	}
+	#ifdef PBL_COLOR
+		if (host_blit.op != GCompOpSet || !gcolor_equal(gbitmap_get_palette(fill)[1], GColorBlack) ||
+			!gcolor_equal(gbitmap_get_palette(fill)[0], GColorClear))
+	#else
+		DrawMask(NULL, fill, center, GColorBlack);
+		GCompOp black = host_blit.op;
+		DrawMask(NULL, fill, center, GColorWhite);
+		if (black != GCompOpClear || host_blit.op != GCompOpOr)
+	#endif
+	{
+		printf("FAIL: mask compositing %d\n", host_blit.op);
+		failed = 1;
+	}
+
+	printf("%-8s %-10s r=%d %s\n", PBL_NAME, "raster", r, failed ? "FAIL" : "ok");
+	return failed;
+}
@@ -0,0 +1,89 @@
+// Worst-case draw calls per frame at every zoom level, must stay within FRAME_BUDGET,
+// and tap zoom must fall back to ZOOM_DEFAULT without touching persist
+#define main app_main
+#include "../src/main.c"
+#undef main
+
+static void place(Planet_t *planet, int32_t deg)
+{
+	int32_t angleC;
+	planet->angleC = ((deg % 360) + 360) % 360;
+	angleC = TRIG_MAX_ANGLE * planet->angleC / 360;
+	planet->sinC = sin_lookup(angleC);
+	planet->cosC = cos_lookup(angleC);
+}
+
+static uint32_t frame(void)
+{
+	static Layer *layer;
+	if (layer == NULL)
+		layer = layer_create(host_screen);
+	host_reset_counters();
+	face_update_proc(layer, NULL);
+	return host_count.draws + host_count.gpaths + host_count.texts * COST_TEXT;
+}
+
+int main(void)
+{
+	int failed = 0;
+	
+	//Everything on that costs draw calls
+	CfgData.stars = CfgData.astro = true;
+	strcpy(CfgData.date, "20150101");
+	Star.size = 1;
+	b_started = b_initialized = true;
+	init_sky();
+	
+	printf("%-8s %-6s %8s %8s\n", PBL_NAME, "zoom", "worst", "budget");
+	for (zoom = 0; zoom < ZOOM_MAX; zoom++)
+	{
+		uint32_t worst = 0, warnings = 0;
+		srand(1);
+		for (int minute = 0; minute < 12*60; minute += 3)
+		{
+			aktHH = minute / 60;
+			aktMM = minute % 60;
+			int32_t view = minute / 2;	//Hand angle in degrees
+			
+			//All planets lined up in view, then random spreads around it
+			for (int trial = 0; trial < 40; trial++)
+			{
+				for (int i=0; i<PLANETS_MAX; i++)
+					place(&Planets[i], view + (trial == 0 ? 0 : rand() % (trial < 20 ? 60 : 360) - (trial < 20 ? 30 : 180)));
+				place(&Moon, rand() % 360);
+				place(&Star, view + rand() % 60 - 30);
+				
+				uint32_t cost = frame();
+				warnings += host_count.warnings;
+				if (cost > worst)
+					worst = cost;
+			}
+		}
+		
+		printf("%-8s %-6d %8u %8d\n", PBL_NAME, zoom, worst, FRAME_BUDGET);
+		if (worst > FRAME_BUDGET || warnings)
+		{
+			printf("FAIL: zoom %d over budget (%u frames warned)\n", zoom, warnings);
+			failed = 1;
+		}
+	}
+	
+	//Wrist flicks tap too: no flash writes, back to the default view on timeout
+	zoom = ZOOM_DEFAULT;
+	host_reset_counters();
+	tap_handler(ACCEL_AXIS_X, 1);
+	if (zoom == ZOOM_DEFAULT || host_count.persists)
+	{
+		printf("FAIL: tap did not zoom or wrote persist (%u writes)\n", host_count.persists);
+		failed = 1;
+	}
+	host_run_timers();
+	if (zoom != ZOOM_DEFAULT)
+	{
+		printf("FAIL: zoom %d kept after timeout\n", zoom);
+		failed = 1;
+	}
+	printf("%-8s %-6s %8s\n", PBL_NAME, "tap", failed ? "FAIL" : "ok");
+	
+	return failed;
+}
@@ -0,0 +1,71 @@
+// Work and host time from init() to the end of the first frame, with the
+// startup work deferred (current) and done eagerly before the first frame
+// (as before the deferral)
+#define main app_main
+#include "../src/main.c"
+#undef main
+
+#define RUNS 501
+
+static double now_us(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static int cmp(const void *a, const void *b)
+{
+	double d = *(const double *)a - *(const double *)b;
+	return d < 0 ? -1 : d > 0;
+}
+
+static HostCounters_t launch(bool eager, double *us)
+{
+	host_reset_persist();
+	persist_write_bool(CONFIG_KEY_STARS, true);
+	persist_write_bool(CONFIG_KEY_ASTRO, true);
+	persist_write_bool(CONFIG_KEY_ANIM, false);
+	persist_write_string(CONFIG_KEY_DATE, "20150101");
+	b_stars = b_astro = false;
+	host_reset_counters();
+	
+	double start = now_us();
+	init();
+	if (eager)
+		startup_callback(NULL);
+	face_update_proc(face_layer, NULL);
+	*us = now_us() - start;
+	
+	HostCounters_t first = host_count;
+	host_run_timers();	//Deferred work, after the first frame
+	deinit();
+	return first;
+}
+
+int main(void)
+{
+	int failed = 0;
+	printf("%-8s %-9s %8s %6s %6s %6s %10s\n", PBL_NAME, "startup", "trig", "rand", "fonts", "draws", "median us");
+	
+	HostCounters_t counts[2];
+	for (int eager = 1; eager >= 0; eager--)
+	{
+		double us[RUNS];
+		for (int i = 0; i < RUNS; i++)
+			counts[eager] = launch(eager, &us[i]);
+		qsort(us, RUNS, sizeof(double), cmp);
+		
+		printf("%-8s %-9s %8u %6u %6u %6u %10.1f\n", PBL_NAME, eager ? "eager" : "deferred",
+			counts[eager].trig, counts[eager].rands, counts[eager].fonts, 
+			counts[eager].draws + counts[eager].texts, us[RUNS/2]);
+	}
+	
+	//Stars, asteroids and the font must wait for the first frame
+	if (counts[0].rands != 0 || counts[0].fonts != 0 || counts[0].trig >= counts[1].trig)
+	{
+		printf("FAIL: startup work before the first frame\n");
+		failed = 1;
+	}
+	return failed;
+}